@@ -5,6 +5,12 @@
 #include <sstream>
 #include <ctime>
 #include <map>
+#include <unordered_map>
+#include <algorithm>
+#include <cstdlib>
+#include <cstdio>
+#include "text_index.h"
+#include "perf_stats.h"
 
 struct Expense
 {
@@ -18,16 +24,21 @@ struct Expense
 std::vector<Expense> expenses;
 int expenseCounter = 1;
 const double DAILY_LIMIT = 500.0;
+TextIndex noteIndex; // words of each expense note -> expense ids
+std::unordered_map<int, size_t> expensePos; // expense id -> position in expenses
+std::string expenseFile = "expenses.txt";
 
 // Load expenses from file
 void loadExpenses()
 {
-    std::ifstream file("expenses.txt");
+    ScopedTimer timer("loadExpenses");
+    std::ifstream file(expenseFile);
     std::string line;
     expenses.clear();
 
     while (std::getline(file, line))
     {
+        timer.addBytes(line.size() + 1);
         std::istringstream ss(line);
         Expense e;
         std::string amountStr;
@@ -41,6 +52,18 @@ void loadExpenses()
         expenses.push_back(e);
         expenseCounter = std::max(expenseCounter, e.id + 1); // d
     }
+    timer.addRecords(expenses.size());
+    timer.stop(); // the index rebuild below is timed on its own
+
+    ScopedTimer indexTimer("buildNoteIndex");
+    noteIndex.clear();
+    expensePos.clear();
+    for (size_t i = 0; i < expenses.size(); i++)
+    {
+        noteIndex.add(expenses[i].id, expenses[i].note);
+        expensePos[expenses[i].id] = i;
+    }
+    indexTimer.addRecords(expenses.size());
 }
 
 // Menu
@@ -53,6 +76,8 @@ void showMenu()
     std::cout << "2. View All Expenses\n";
     std::cout << "3. View Category Summary\n";
     std::cout << "4. Smart Spending Suggestions\n";
+    std::cout << "5. Search Expenses by Note\n";
+    std::cout << "6. Show Performance Stats\n";
     std::cout << "0. Exit\n";
     std::cout << "===============================\n";
     std::cout << "Enter your choice: ";
@@ -89,11 +114,14 @@ std::string getTodayDate()
 // Save expenses to file
 void saveExpenses()
 {
-    std::ofstream file("expenses.txt");
+    ScopedTimer timer("saveExpenses");
+    std::ofstream file(expenseFile);
     for (const auto &e : expenses)
     {
         file << e.id << "," << e.category << "," << e.amount << "," << e.date << "," << e.note << "\n";
     }
+    timer.addRecords(expenses.size());
+    timer.addBytes(file.tellp());
 }
 
 // Add a new expense
@@ -113,30 +141,69 @@ void addExpense()
     e.date = getTodayDate();
 
     expenses.push_back(e);
+    noteIndex.add(e.id, e.note);
+    expensePos[e.id] = expenses.size() - 1;
     saveExpenses();
     std::cout << "Expense added successfully!\n";
 }
 
+void printExpense(const Expense &e)
+{
+    std::cout << "ID: " << e.id
+              << " | Category: " << e.category
+              << " | Amount: " << e.amount
+              << " | Date: " << e.date
+              << " | Note: " << e.note << "\n";
+}
+
 // View all expenses
 void viewExpense()
 {
     std::cout << "\n--- Expense List ---\n";
     for (const auto &e : expenses)
+        printExpense(e);
+}
+
+// Ids of the expenses whose note has all the given words ("ub*" matches a prefix)
+std::vector<int> findExpenses(const std::string &query)
+{
+    ScopedTimer timer("search");
+    std::vector<int> ids = noteIndex.search(query);
+    timer.addRecords(ids.size());
+    return ids;
+}
+
+void searchExpenses()
+{
+    std::string query;
+    std::cin.ignore();
+    std::cout << "Enter words to search for (end a word with * for prefix match): ";
+    std::getline(std::cin, query);
+
+    std::vector<int> ids = findExpenses(query);
+    std::cout << "\n--- Search Results (" << ids.size() << ") ---\n";
+    for (int id : ids)
     {
-        std::cout << "ID: " << e.id
-                  << " | Category: " << e.category
-                  << " | Amount: " << e.amount
-                  << " | Date: " << e.date
-                  << " | Note: " << e.note << "\n";
+        auto it = expensePos.find(id);
+        if (it != expensePos.end())
+            printExpense(expenses[it->second]);
     }
 }
 
-// View category-wise summary
-void categorySummary() {
+// Total amount per category
+std::map<std::string,double> summarizeByCategory() {
+    ScopedTimer timer("categorySummary");
     std::map<std::string,double> summary;
     for(auto& e: expenses){
         summary[e.category] += e.amount;
     }
+    timer.addRecords(expenses.size());
+    return summary;
+}
+
+// View category-wise summary
+void categorySummary() {
+    std::map<std::string,double> summary = summarizeByCategory();
      std::cout << "\n--- Category-wise Summary ---\n";
     for(const auto& pair: summary){
         std::cout<<pair.first<<": Rs"<<pair.second<<std::endl;
@@ -173,8 +240,69 @@ void showSuggestions() {
     std::cout<<"No expenses added yet.\n";
 }
 
-int main()
+// Fill expenses with n synthetic records spread over a few categories
+void generateExpenses(long long n)
 {
+    const char *categories[] = {"Food", "Travel", "Bills", "Shopping", "Health", "Rent"};
+    const char *notes[] = {"Uber Ride", "Pizza", "Electricity bill", "Pav Bhaji", "Groceries", "Movie tickets", "Pharmacy", "Monthly rent"};
+    unsigned int seed = 12345;
+    expenses.clear();
+    expenses.reserve(n);
+    for (long long i = 0; i < n; i++)
+    {
+        seed = seed * 1103515245u + 12345u;
+        Expense e;
+        e.id = (int)i + 1;
+        e.category = categories[(seed >> 8) % 6];
+        e.amount = 10 + (seed >> 4) % 2000;
+        char date[11];
+        std::snprintf(date, sizeof(date), "2025-%02u-%02u", 1 + (seed >> 12) % 12, 1 + (seed >> 16) % 28);
+        e.date = date;
+        e.note = notes[(seed >> 20) % 8];
+        expenses.push_back(e);
+    }
+    expenseCounter = (int)n + 1;
+}
+
+// Save, reload, summarize and search (one exact, one prefix query) n synthetic
+// expenses in a scratch file for each size, printing the stats of every run
+void runBenchmark(const std::vector<long long> &sizes)
+{
+    expenseFile = "bench_expenses.txt";
+    for (long long n : sizes)
+    {
+        perfStats().reset();
+        generateExpenses(n);
+        saveExpenses();
+        loadExpenses();
+        summarizeByCategory();
+        findExpenses("uber");
+        findExpenses("elec*");
+        std::cout << "\n=== " << n << " records ===";
+        perfStats().dump(std::cout);
+    }
+    std::remove(expenseFile.c_str());
+    expenses.clear();
+}
+
+int main(int argc, char *argv[])
+{
+    // --bench [records...] runs the synthetic benchmark (default 10k, 1M, 10M records)
+    // --stats prints the performance stats on exit
+    bool statsOnExit = false;
+    if (argc > 1 && std::string(argv[1]) == "--bench")
+    {
+        std::vector<long long> sizes;
+        for (int i = 2; i < argc; i++)
+            sizes.push_back(std::atoll(argv[i]));
+        if (sizes.empty())
+            sizes = {10000, 1000000, 10000000};
+        runBenchmark(sizes);
+        return 0;
+    }
+    if (argc > 1 && std::string(argv[1]) == "--stats")
+        statsOnExit = true;
+
     loadExpenses();
     int choice;
     do
@@ -195,6 +323,12 @@ int main()
         case 4:
             showSuggestions();
             break;
+        case 5:
+            searchExpenses();
+            break;
+        case 6:
+            perfStats().dump(std::cout);
+            break;
         case 0:
             std::cout << "Goodbye! \n";
             break;
@@ -204,5 +338,7 @@ int main()
         }
     } while (choice != 0);
 
+    if (statsOnExit)
+        perfStats().dump(std::cout);
     return 0;
 }
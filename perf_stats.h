@@ -0,0 +1,193 @@
+#ifndef PERF_STATS_H
+#define PERF_STATS_H
+
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+// Histogram of durations in nanoseconds. Values below 16 get their own
+// bucket, above that each power of two is split into 4 buckets, so a
+// percentile is within 12.5% of the true value.
+struct LatencyHistogram
+{
+    std::vector<long long> counts = std::vector<long long>(16 + 60 * 4, 0);
+    long long total = 0;
+    long long sumNs = 0;
+    long long minNs = 0;
+    long long maxNs = 0;
+
+    void add(long long ns)
+    {
+        ns = std::max(0LL, ns);
+        int bucket;
+        if (ns < 16)
+            bucket = (int)ns;
+        else
+        {
+            int e = 4;
+            while ((ns >> (e + 1)) != 0)
+                e++;
+            bucket = 16 + (e - 4) * 4 + (int)((ns >> (e - 2)) & 3);
+        }
+        counts[std::min(bucket, (int)counts.size() - 1)]++;
+        minNs = (total == 0) ? ns : std::min(minNs, ns);
+        maxNs = std::max(maxNs, ns);
+        total++;
+        sumNs += ns;
+    }
+
+    void merge(const LatencyHistogram &other)
+    {
+        if (other.total == 0)
+            return;
+        for (size_t i = 0; i < counts.size(); i++)
+            counts[i] += other.counts[i];
+        minNs = (total == 0) ? other.minNs : std::min(minNs, other.minNs);
+        maxNs = std::max(maxNs, other.maxNs);
+        total += other.total;
+        sumNs += other.sumNs;
+    }
+
+    // Midpoint of the bucket holding the p-th fraction of samples, clamped to
+    // the smallest and largest value seen.
+    long long percentile(double p) const
+    {
+        long long rank = (long long)(p * total), seen = 0;
+        for (size_t i = 0; i < counts.size(); i++)
+        {
+            seen += counts[i];
+            if (seen > rank)
+            {
+                long long value = (long long)i;
+                if (i >= 16)
+                {
+                    int e = (int)(i - 16) / 4 + 4;
+                    long long width = 1LL << (e - 2);
+                    value = (4LL + (long long)((i - 16) % 4)) * width + width / 2;
+                }
+                return std::min(maxNs, std::max(minNs, value));
+            }
+        }
+        return maxNs;
+    }
+};
+
+// Call times plus record and byte totals for one named code path.
+struct PerfMetric
+{
+    LatencyHistogram time;
+    long long records = 0;
+    long long bytes = 0;
+
+    void record(long long ns, long long recordCount, long long byteCount)
+    {
+        time.add(ns);
+        records += recordCount;
+        bytes += byteCount;
+    }
+};
+
+// All metrics of the program, keyed by path name. Not thread-safe; both tools
+// are single threaded.
+class PerfStats
+{
+public:
+    PerfMetric &get(const std::string &name)
+    {
+        return metrics[name];
+    }
+
+    void reset()
+    {
+        metrics.clear();
+    }
+
+    void dump(std::ostream &out) const
+    {
+        out << "\n--- Performance Stats ---\n";
+        if (metrics.empty())
+        {
+            out << "Nothing measured yet.\n";
+            return;
+        }
+        out << std::left << std::setw(20) << "path" << std::right
+            << std::setw(7) << "calls"
+            << std::setw(11) << "p50 ms"
+            << std::setw(11) << "p99 ms"
+            << std::setw(11) << "max ms"
+            << std::setw(12) << "records"
+            << std::setw(13) << "bytes"
+            << std::setw(14) << "records/s"
+            << std::setw(9) << "MB/s" << "\n";
+
+        std::ios_base::fmtflags flags = out.flags();
+        std::streamsize precision = out.precision();
+        for (const auto &pair : metrics)
+        {
+            const PerfMetric &m = pair.second;
+            double secs = m.time.sumNs / 1e9;
+            out << std::left << std::setw(20) << pair.first << std::right
+                << std::setw(7) << m.time.total
+                << std::fixed << std::setprecision(3)
+                << std::setw(11) << m.time.percentile(0.50) / 1e6
+                << std::setw(11) << m.time.percentile(0.99) / 1e6
+                << std::setw(11) << m.time.maxNs / 1e6
+                << std::setw(12) << m.records
+                << std::setw(13) << m.bytes
+                << std::setprecision(0)
+                << std::setw(14) << (secs > 0 ? m.records / secs : 0.0)
+                << std::setprecision(1)
+                << std::setw(9) << (secs > 0 ? m.bytes / secs / 1e6 : 0.0) << "\n";
+        }
+        out.flags(flags);
+        out.precision(precision);
+    }
+
+private:
+    std::map<std::string, PerfMetric> metrics;
+};
+
+inline PerfStats &perfStats()
+{
+    static PerfStats stats;
+    return stats;
+}
+
+// Times the enclosing scope and files the result under name when it ends (or
+// at stop(), if called earlier), along with any records/bytes counted through it.
+class ScopedTimer
+{
+public:
+    explicit ScopedTimer(const char *name)
+        : metric(perfStats().get(name)), start(std::chrono::steady_clock::now()) {}
+
+    ~ScopedTimer()
+    {
+        stop();
+    }
+
+    void stop()
+    {
+        if (stopped)
+            return;
+        long long ns = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+        metric.record(ns, records, bytes);
+        stopped = true;
+    }
+
+    void addRecords(long long n) { records += n; }
+    void addBytes(long long n) { bytes += n; }
+
+private:
+    PerfMetric &metric;
+    std::chrono::steady_clock::time_point start;
+    long long records = 0;
+    long long bytes = 0;
+    bool stopped = false;
+};
+
+#endif
@@ -11,6 +11,11 @@
 #include <ctime>
 #include <algorithm>
 #include <sstream>
+#include <unordered_map>
+#include <cstdlib>
+#include <cstdio>
+#include "text_index.h"
+#include "perf_stats.h"
 
 void saveTasks();
 
@@ -27,6 +32,7 @@ struct Task
     double priorityScore()
     {
         int daysLeft = getDaysUntilDeadline(deadline); // calculate how many days left from deadline
+        return daysLeft;
     }
 
     // Helper to calculate days left till deadline
@@ -77,14 +83,27 @@ struct Task
 
 std::vector<Task> tasks;
 int taskCounter = 1;
+TextIndex nameIndex; // words of each task name -> task ids
+std::unordered_map<int, size_t> taskPos; // task id -> position in tasks
+std::string taskFile = "tasks.txt";
+
+// Rebuild taskPos after tasks was loaded or reordered
+void indexTaskPositions()
+{
+    taskPos.clear();
+    for (size_t i = 0; i < tasks.size(); i++)
+        taskPos[tasks[i].id] = i;
+}
 
 void loadTask()
 {
-    std::ifstream file("tasks.txt");
+    ScopedTimer timer("loadTask");
+    std::ifstream file(taskFile);
     std::string line;
     tasks.clear();
     while (std::getline(file, line))
     {
+        timer.addBytes(line.size() + 1);
         Task t;
         char delim;
         std::istringstream ss(line);
@@ -96,7 +115,12 @@ void loadTask()
         // std::getline(ss, t.name, ',');
         // Reads the task name until it sees a comma.
         // Supports names with spaces.
-        ss >> t.duration >> delim;
+        // Files written before saveTasks() stored the duration have only 4
+        // fields (id,name,deadline,isDone); their duration is unknown.
+        if (std::count(line.begin(), line.end(), ',') >= 4)
+            ss >> t.duration >> delim;
+        else
+            t.duration = 0;
         // We consume the comma immediately after the number:
         // ss >> t.duration >> delim;
         // t.duration = 20
@@ -110,6 +134,23 @@ void loadTask()
         tasks.push_back(t);
         taskCounter = std::max(taskCounter, t.id + 1);
     }
+    timer.addRecords(tasks.size());
+    timer.stop(); // the index rebuild below is timed on its own
+
+    // viewTasks() sorts tasks by priority and the next saveTasks() writes them
+    // out in that order, so the file need not be in id order. Feed the index
+    // by id to keep every posting list on its append-only path.
+    ScopedTimer indexTimer("buildNameIndex");
+    std::vector<const Task *> byId;
+    for (const Task &t : tasks)
+        byId.push_back(&t);
+    std::sort(byId.begin(), byId.end(), [](const Task *a, const Task *b)
+              { return a->id < b->id; });
+    nameIndex.clear();
+    for (const Task *t : byId)
+        nameIndex.add(t->id, t->name);
+    indexTaskPositions();
+    indexTimer.addRecords(tasks.size());
 };
 
 // ==========================
@@ -125,6 +166,8 @@ void showMenu()
     std::cout << "2. View Tasks\n";
     std::cout << "3. Suggest Task\n";
     std::cout << "4. Mark Task as Done\n";
+    std::cout << "5. Search Tasks\n";
+    std::cout << "6. Show Performance Stats\n";
     std::cout << "0. Exit\n";
     std::cout << "================================\n";
 }
@@ -147,6 +190,8 @@ void addTask()
     t.isDone = false; // Marks this task as not completed when initially added.
 
     tasks.push_back(t);
+    nameIndex.add(t.id, t.name);
+    taskPos[t.id] = tasks.size() - 1;
     std::cout << "Task added successfully!\n";
     saveTasks();
 }
@@ -157,7 +202,8 @@ void addTask()
 
 void saveTasks()
 {
-    std::ofstream file("tasks.txt");
+    ScopedTimer timer("saveTasks");
+    std::ofstream file(taskFile);
 
     // std::ofstream: Creates an output file stream object named file using std::ofstream (from <fstream> header).
     // If tasks.txt doesn't exist, it creates one.
@@ -166,23 +212,58 @@ void saveTasks()
 
     for (const Task &t : tasks)
     {
-        file << t.id << "," << t.name << "," << t.deadline << "," << t.isDone << "\n";
+        file << t.id << "," << t.name << "," << t.duration << "," << t.deadline << "," << t.isDone << "\n";
     }
+    timer.addRecords(tasks.size());
+    timer.addBytes(file.tellp());
+}
+
+void sortTasks()
+{
+    ScopedTimer timer("viewTasks.sort");
+
+    // priorityScore() calls mktime(), so work it out once per task instead of
+    // twice per comparison, then sort (score, position) pairs.
+    std::vector<std::pair<double, size_t>> order;
+    order.reserve(tasks.size());
+    for (size_t i = 0; i < tasks.size(); i++)
+        order.push_back({tasks[i].priorityScore(), i});
+
+    std::sort(order.begin(), order.end(), [](const std::pair<double, size_t> &a, const std::pair<double, size_t> &b)
+              { return a.first < b.first; });
+
+    std::vector<Task> sorted;
+    sorted.reserve(tasks.size());
+    for (const auto &p : order)
+        sorted.push_back(std::move(tasks[p.second]));
+    tasks.swap(sorted);
+    indexTaskPositions();
+    timer.addRecords(tasks.size());
+}
+
+void printTask(const Task &t)
+{
+    std::cout << "ID: " << t.id
+              << " | Name: " << t.name
+              << " | Duration: " << t.duration << " mins"
+              << " | Deadline: " << t.deadline
+              << " | Status: " << (t.isDone ? "Done" : "Pending")
+              << "\n";
 }
 
 void viewTasks()
 {
-    std::sort(tasks.begin(), tasks.end(), [](Task a, Task b)
-              { return a.priorityScore() < b.priorityScore(); });
+    sortTasks();
 
     //  What it does:
-    // Sorts the tasks vector in-place, from highest priority to lowest.
-    // It uses a lambda function ([](Task a, Task b) { ... }) to compare two tasks.
-    // Tasks are compared based on their priorityScore() value (lower score = higher priority).
+    // sortTasks() puts the tasks in priority order, highest priority first.
+    // It computes each task's priorityScore() once (lower score = higher priority),
+    // sorts (score, position) pairs with a lambda comparator, then moves the
+    // tasks into a new vector in that order and swaps it into tasks.
     // 📚 Standard Library Features:
     // std::sort → from <algorithm>
     // Lambda expressions → from C++11
-    // tasks.begin() and tasks.end() → standard vector iterators from <vector>
+    // std::move / vector::swap → hand the Task objects over without copying them
     // 🧠 Example:
     // If you have tasks like:
     // Eat (score 3.2), Study (score 2.1), Read (score 5.0)
@@ -190,14 +271,7 @@ void viewTasks()
 
     std::cout << "\n-- Task List --\n";
     for (const Task &t : tasks)
-    {
-        std::cout << "ID: " << t.id
-                  << " | Name: " << t.name
-                  << " | Duration: " << t.duration << " mins"
-                  << " | Deadline: : " << t.deadline
-                  << " | Status: " << (t.isDone ? "Done" : "Pending")
-                  << "\n";
-    }
+        printTask(t);
 }
 
 void suggestTask()
@@ -236,6 +310,32 @@ void suggestTask()
     }
 }
 
+// Ids of the tasks whose name has all the given words ("gro*" matches a prefix)
+std::vector<int> findTasks(const std::string &query)
+{
+    ScopedTimer timer("search");
+    std::vector<int> ids = nameIndex.search(query);
+    timer.addRecords(ids.size());
+    return ids;
+}
+
+void searchTasks()
+{
+    std::string query;
+    std::cin.ignore();
+    std::cout << "Enter words to search for (end a word with * for prefix match): ";
+    std::getline(std::cin, query);
+
+    std::vector<int> ids = findTasks(query);
+    std::cout << "\n-- Search Results (" << ids.size() << ") --\n";
+    for (int id : ids)
+    {
+        auto it = taskPos.find(id);
+        if (it != taskPos.end())
+            printTask(tasks[it->second]);
+    }
+}
+
 void markDone()
 {
     int id;
@@ -258,8 +358,68 @@ void markDone()
 // Main Function
 // ==========================
 
-int main()
+// Fill tasks with n synthetic tasks with deadlines spread over a year
+void generateTasks(long long n)
 {
+    const char *names[] = {"Read", "Medicine", "Buy groceries", "Pay bills", "Gym workout", "Write report", "Call mom", "Clean room"};
+    unsigned int seed = 12345;
+    tasks.clear();
+    tasks.reserve(n);
+    for (long long i = 0; i < n; i++)
+    {
+        seed = seed * 1103515245u + 12345u;
+        Task t;
+        t.id = (int)i + 1;
+        t.name = names[(seed >> 8) % 8];
+        t.duration = 5 + (seed >> 4) % 120;
+        char deadline[11];
+        std::snprintf(deadline, sizeof(deadline), "2025-%u-%u", 1 + (seed >> 12) % 12, 1 + (seed >> 16) % 28);
+        t.deadline = deadline;
+        t.isDone = ((seed >> 20) % 4) == 0;
+        tasks.push_back(t);
+    }
+    taskCounter = (int)n + 1;
+}
+
+// Save, reload, sort and search (one exact, one prefix query) n synthetic tasks
+// in a scratch file for each size, printing the stats of every run
+void runBenchmark(const std::vector<long long> &sizes)
+{
+    taskFile = "bench_tasks.txt";
+    for (long long n : sizes)
+    {
+        perfStats().reset();
+        generateTasks(n);
+        saveTasks();
+        loadTask();
+        sortTasks();
+        findTasks("medicine");
+        findTasks("gro*");
+        std::cout << "\n=== " << n << " records ===";
+        perfStats().dump(std::cout);
+    }
+    std::remove(taskFile.c_str());
+    tasks.clear();
+}
+
+int main(int argc, char *argv[])
+{
+    // --bench [records...] runs the synthetic benchmark (default 10k, 1M, 10M records)
+    // --stats prints the performance stats on exit
+    bool statsOnExit = false;
+    if (argc > 1 && std::string(argv[1]) == "--bench")
+    {
+        std::vector<long long> sizes;
+        for (int i = 2; i < argc; i++)
+            sizes.push_back(std::atoll(argv[i]));
+        if (sizes.empty())
+            sizes = {10000, 1000000, 10000000};
+        runBenchmark(sizes);
+        return 0;
+    }
+    if (argc > 1 && std::string(argv[1]) == "--stats")
+        statsOnExit = true;
+
     loadTask();
     int choice;
     do
@@ -281,6 +441,12 @@ int main()
         case 4:
             markDone();
             break;
+        case 5:
+            searchTasks();
+            break;
+        case 6:
+            perfStats().dump(std::cout);
+            break;
         case 0:
             std::cout << "Goodbye!\n";
             break;
@@ -289,5 +455,8 @@ int main()
             break;
         }
     } while (choice != 0);
+
+    if (statsOnExit)
+        perfStats().dump(std::cout);
     return 0;
 }
\ No newline at end of file
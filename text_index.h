@@ -0,0 +1,177 @@
+#ifndef TEXT_INDEX_H
+#define TEXT_INDEX_H
+
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+// Inverted index from lowercase words to the ids of the records that contain
+// them. The term dictionary is a sorted map, so prefix queries are a range
+// scan from lower_bound(prefix). Each posting list is stored as varint-encoded
+// gaps between increasing ids.
+class TextIndex
+{
+public:
+    void clear()
+    {
+        terms.clear();
+    }
+
+    // Index every word of text under id. Adding ids in increasing order is
+    // the fast path (a plain append); an older id is merged into the list.
+    void add(int id, const std::string &text)
+    {
+        for (const std::string &word : tokenize(text))
+        {
+            Postings &p = terms[word];
+            if (id > p.last)
+                append(p, id);
+            else if (id < p.last)
+                insert(p, id);
+        }
+    }
+
+    // Ids (sorted) of the records matching every word of the query. A word
+    // ending in '*' matches any term starting with it, e.g. "ub*" finds "uber".
+    std::vector<int> search(const std::string &query) const
+    {
+        std::vector<int> result;
+        bool first = true;
+
+        std::string word;
+        for (size_t i = 0; i <= query.size(); i++)
+        {
+            char c = (i < query.size()) ? query[i] : ' ';
+            if (std::isalnum((unsigned char)c) || c == '*')
+            {
+                word += (char)std::tolower((unsigned char)c);
+                continue;
+            }
+            if (word.empty())
+                continue;
+
+            std::vector<int> ids = lookup(word);
+            if (first)
+                result.swap(ids);
+            else
+            {
+                std::vector<int> both;
+                std::set_intersection(result.begin(), result.end(), ids.begin(), ids.end(), std::back_inserter(both));
+                result.swap(both);
+            }
+            first = false;
+            word.clear();
+            if (result.empty())
+                break;
+        }
+        return result;
+    }
+
+    size_t termCount() const
+    {
+        return terms.size();
+    }
+
+private:
+    struct Postings
+    {
+        std::vector<uint8_t> bytes;
+        int last = -1; // largest id in the list
+    };
+
+    std::map<std::string, Postings> terms;
+
+    static std::vector<std::string> tokenize(const std::string &text)
+    {
+        std::vector<std::string> words;
+        std::string word;
+        for (size_t i = 0; i <= text.size(); i++)
+        {
+            char c = (i < text.size()) ? text[i] : ' ';
+            if (std::isalnum((unsigned char)c))
+                word += (char)std::tolower((unsigned char)c);
+            else if (!word.empty())
+            {
+                words.push_back(word);
+                word.clear();
+            }
+        }
+        return words;
+    }
+
+    // Gap from the previous id (or from -1), 7 bits per byte, high bit = more.
+    static void append(Postings &p, int id)
+    {
+        uint32_t gap = (uint32_t)(id - p.last - 1);
+        while (gap >= 0x80)
+        {
+            p.bytes.push_back((uint8_t)(gap | 0x80));
+            gap >>= 7;
+        }
+        p.bytes.push_back((uint8_t)gap);
+        p.last = id;
+    }
+
+    static void decode(const Postings &p, std::vector<int> &out)
+    {
+        int id = -1;
+        uint32_t gap = 0;
+        int shift = 0;
+        for (uint8_t b : p.bytes)
+        {
+            gap |= (uint32_t)(b & 0x7F) << shift;
+            shift += 7;
+            if (b & 0x80)
+                continue;
+            id += (int)gap + 1;
+            out.push_back(id);
+            gap = 0;
+            shift = 0;
+        }
+    }
+
+    static void insert(Postings &p, int id)
+    {
+        std::vector<int> ids;
+        decode(p, ids);
+        auto pos = std::lower_bound(ids.begin(), ids.end(), id);
+        if (pos != ids.end() && *pos == id)
+            return;
+        ids.insert(pos, id);
+
+        p = Postings();
+        for (int i : ids)
+            append(p, i);
+    }
+
+    std::vector<int> lookup(const std::string &word) const
+    {
+        std::vector<int> ids;
+        if (word.back() != '*')
+        {
+            auto it = terms.find(word);
+            if (it != terms.end())
+                decode(it->second, ids);
+            return ids;
+        }
+
+        std::string prefix = word.substr(0, word.find('*'));
+        size_t lists = 0;
+        for (auto it = terms.lower_bound(prefix); it != terms.end() && it->first.compare(0, prefix.size(), prefix) == 0; ++it)
+        {
+            decode(it->second, ids);
+            lists++;
+        }
+        if (lists > 1)
+        {
+            std::sort(ids.begin(), ids.end());
+            ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+        }
+        return ids;
+    }
+};
+
+#endif
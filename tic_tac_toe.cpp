@@ -2,187 +2,700 @@
 #include <algorithm>
 #include <limits>
 #include <ios>
+#include <iomanip>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <chrono>
+#include <string>
+#include <cstdlib>
+#include <cstdint>
+#include <cmath>
+#include <memory>
+#include <functional>
+#include <mutex>
+#include <condition_variable>
+#include "perf_stats.h"
 
-int minimax(int,bool);
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#ifndef ENABLE_VIRTUAL_TERMINAL_PROCESSING
+#define ENABLE_VIRTUAL_TERMINAL_PROCESSING 0x0004
+#endif
+#endif
+
+int minimax(char b[3][3], int depth, bool isMax);
+bool isMovesLeft(char b[3][3]);
 
 bool vsAi = false;
-char board[3][3] = {{'1', '2', '3'}, {'4', '5', '6'}, {'7', '8', '9'}};
-bool draw = false;
-char turn = 'X';
 
-int evaluate()
+// Search settings. Root moves are split across aiThreads workers.
+int hardwareThreads = std::max(1, (int)std::thread::hardware_concurrency());
+int aiThreads = hardwareThreads;
+bool useTT = true;
+
+// Transposition table shared by all search threads: one slot per position
+// (base-3 board code) and side to move. Minimax scores are exact and do not
+// depend on depth, so two threads racing on a slot always write the same value
+// and relaxed atomics are enough. Slots hold score + TT_BIAS, 0 means empty.
+const int TT_SIZE = 19683 * 2;
+const int TT_BIAS = 11;
+std::atomic<signed char> transposition[TT_SIZE];
+
+// Nodes visited by the current thread during one root search.
+thread_local long long nodeCount = 0;
+
+// Search threads started once and reused: run() hands a job to threads - 1
+// waiting workers, runs it on the calling thread as well, and returns when
+// every copy has finished. Only one job runs at a time.
+class SearchPool
+{
+public:
+    ~SearchPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m);
+            quit = true;
+        }
+        wake.notify_all();
+        for (auto &th : workers)
+            th.join();
+    }
+
+    void run(int threads, const std::function<void()> &fn)
+    {
+        std::lock_guard<std::mutex> serial(runLock);
+        int helpers = std::max(0, threads - 1);
+        {
+            std::unique_lock<std::mutex> lock(m);
+            while ((int)workers.size() < helpers)
+                workers.emplace_back(&SearchPool::workerLoop, this);
+            job = &fn;
+            pending = helpers;
+            running = helpers;
+            generation++;
+        }
+        wake.notify_all();
+
+        fn();
+
+        std::unique_lock<std::mutex> lock(m);
+        done.wait(lock, [this]
+                  { return running == 0; });
+        job = nullptr;
+    }
+
+private:
+    std::mutex runLock;
+    std::mutex m;
+    std::condition_variable wake, done;
+    std::vector<std::thread> workers;
+    const std::function<void()> *job = nullptr;
+    long long generation = 0;
+    int pending = 0; // workers still to pick up the current job
+    int running = 0; // workers that have not finished it yet
+    bool quit = false;
+
+    void workerLoop()
+    {
+        long long seen = 0;
+        std::unique_lock<std::mutex> lock(m);
+        while (true)
+        {
+            wake.wait(lock, [&]
+                      { return quit || generation != seen; });
+            if (quit)
+                return;
+            seen = generation;
+            if (pending == 0)
+                continue;
+            pending--;
+            const std::function<void()> *fn = job;
+            lock.unlock();
+            (*fn)();
+            lock.lock();
+            if (--running == 0)
+                done.notify_all();
+        }
+    }
+};
+
+SearchPool searchPool;
+
+void clearTT()
+{
+    for (int i = 0; i < TT_SIZE; i++)
+        transposition[i].store(0, std::memory_order_relaxed);
+}
+
+int positionKey(char b[3][3], bool isMax)
+{
+    int code = 0;
+    for (int i = 0; i < 3; i++)
+        for (int j = 0; j < 3; j++)
+            code = code * 3 + (b[i][j] == 'X' ? 1 : b[i][j] == 'O' ? 2 : 0);
+    return code * 2 + (isMax ? 1 : 0);
+}
+
+int evaluate(char b[3][3])
 {
     for (int i = 0; i < 3; i++)
     {
-        if (board[i][0] == board[i][1] && board[i][1] == board[i][2])
+        if (b[i][0] == b[i][1] && b[i][1] == b[i][2])
         {
-            return (board[i][0] == 'O') ? 10 : -10; // row
+            return (b[i][0] == 'O') ? 10 : -10; // row
         }
 
-        if (board[0][i] == board[1][i] && board[1][i] == board[2][i])
+        if (b[0][i] == b[1][i] && b[1][i] == b[2][i])
         {
-            return (board[0][i] == 'O') ? 10 : -10; // col
+            return (b[0][i] == 'O') ? 10 : -10; // col
         }
 
-        if (board[0][0] == board[1][1] && board[1][1] == board[2][2])
+        if (b[0][0] == b[1][1] && b[1][1] == b[2][2])
         {
-            return (board[0][0] == 'O') ? 10 : -10; // left diagonal
+            return (b[0][0] == 'O') ? 10 : -10; // left diagonal
         }
 
-        if (board[0][2] == board[1][1] && board[1][1] == board[2][0])
+        if (b[0][2] == b[1][1] && b[1][1] == b[2][0])
         {
-            return (board[0][2] == 'O') ? 10 : -10; // right diagonal
+            return (b[0][2] == 'O') ? 10 : -10; // right diagonal
         }
     }
 
     return 0;
 }
 
-void bestMove()
+// Scores every empty cell of b for side and returns the chosen cell (0-8), or
+// -1 if the board is full. The search pool's workers pull root moves from a
+// shared counter, so a thread that finishes a small subtree early simply takes
+// the next move.
+// The number of nodes visited is stored in *nodes when given.
+int searchRoot(char b[3][3], char side, int threads, long long *nodes = nullptr)
 {
-    int bestVal = -1000;
-    int bestRow = -1, bestCol = -1;
-
+    std::vector<int> moves;
     for (int i = 0; i < 3; i++)
-    {
         for (int j = 0; j < 3; j++)
+            if (b[i][j] != 'X' && b[i][j] != 'O')
+                moves.push_back(i * 3 + j);
+    if (moves.empty())
+        return -1;
+
+    std::vector<int> scores(moves.size());
+    std::atomic<size_t> next(0);
+    std::atomic<long long> visited(0);
+
+    std::function<void()> worker = [&]()
+    {
+        char local[3][3];
+        std::copy(&b[0][0], &b[0][0] + 9, &local[0][0]);
+        nodeCount = 0;
+        for (size_t k = next.fetch_add(1); k < moves.size(); k = next.fetch_add(1))
         {
-            if (board[i][j] != 'X' && board[i][j] != 'O')
-            {
-                char backup = board[i][j];
-                board[i][j] = 'O';
-                int moveVal = minimax(0, false);
-                board[i][j] = backup;
-                if (moveVal > bestVal)
-                {
-                    bestRow = i;
-                    bestCol = j;
-                    bestVal = moveVal;
-                }
-            }
+            int row = moves[k] / 3, col = moves[k] % 3;
+            char backup = local[row][col];
+            local[row][col] = side;
+            // Scores are from O's point of view, so X keeps the lowest one.
+            int score = minimax(local, 0, side == 'X');
+            scores[k] = (side == 'O') ? score : -score;
+            local[row][col] = backup;
+        }
+        visited += nodeCount;
+    };
+
+    threads = std::max(1, std::min(threads, (int)moves.size()));
+    if (threads == 1)
+        worker();
+    else
+        searchPool.run(threads, worker);
+    if (nodes)
+        *nodes = visited;
+
+    // First best move in board order, same as the serial loop picked, so the
+    // choice does not depend on which thread finished first.
+    int bestVal = -1000, best = -1;
+    for (size_t k = 0; k < moves.size(); k++)
+    {
+        if (scores[k] > bestVal)
+        {
+            bestVal = scores[k];
+            best = moves[k];
         }
     }
+    return best;
+}
 
-    board[bestRow][bestCol] = 'O';
-    turn = 'X';
+// ==========================
+// AI engines
+// ==========================
+
+// Common interface for computer players: given the board and the side to
+// play, return the cell (0-8) to take. lastNodes() is the search effort spent
+// on the previous chooseMove() call, in the engine's own unit.
+class AiEngine
+{
+public:
+    virtual ~AiEngine() {}
+    virtual const char *name() const = 0;
+    virtual int chooseMove(char b[3][3], char side) = 0;
+    long long lastNodes() const { return nodes; }
+
+protected:
+    long long nodes = 0;
+};
+
+// Exhaustive minimax with the parallel root split above.
+class MinimaxEngine : public AiEngine
+{
+public:
+    explicit MinimaxEngine(int threads = aiThreads) : threads(threads) {}
+    const char *name() const override { return "Minimax"; }
+    int chooseMove(char b[3][3], char side) override { return searchRoot(b, side, threads, &nodes); }
+
+private:
+    int threads;
+};
+
+// xorshift32 step shared by the engines that play random moves. state must be non-zero.
+uint32_t nextRandom(uint32_t &state)
+{
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return state;
 }
 
-bool gameOver()
+// Plays a uniformly random empty cell. Used as a baseline opponent.
+class RandomEngine : public AiEngine
 {
-    for (int i = 0; i < 3; i++)
+public:
+    explicit RandomEngine(uint32_t seed = 2463534242u) : rng(seed ? seed : 1) {}
+    const char *name() const override { return "Random"; }
+
+    int chooseMove(char b[3][3], char) override
     {
-        if ((board[i][0] == board[i][1] && board[i][1] == board[i][2]) ||
-            (board[0][i] == board[1][i] && board[1][i] == board[2][i])) //row & col
-            return false;
+        int cells[9], count = 0;
+        for (int i = 0; i < 9; i++)
+            if (b[i / 3][i % 3] != 'X' && b[i / 3][i % 3] != 'O')
+                cells[count++] = i;
+        if (count == 0)
+            return -1;
+        return cells[nextRandom(rng) % count];
     }
-    if ((board[0][0] == board[1][1] && board[1][1] == board[2][2]) ||
-        (board[0][2] == board[1][1] && board[1][1] == board[2][0])) //diagonal
-        return false;
 
-    for (int i = 0; i < 3; i++)
-        for (int j = 0; j < 3; j++)
-            if (board[i][j] != 'X' && board[i][j] != 'O')
-                return true;
+private:
+    uint32_t rng;
+};
+
+// Board as two 9-bit masks, bit i*3+j for cell [i][j].
+const uint16_t FULL_BOARD = 0x1FF;
+const uint16_t WIN_MASKS[8] = {0x007, 0x038, 0x1C0, 0x049, 0x092, 0x124, 0x111, 0x054};
 
-    draw = true;
+bool hasLine(uint16_t stones)
+{
+    for (uint16_t m : WIN_MASKS)
+        if ((stones & m) == m)
+            return true;
     return false;
 }
 
-void display_board()
+char otherSide(char side)
 {
-    system("cls");
-    std::cout << "\n     T i c k   C r o s s   G a m e" << std::endl;
-    std::cout << "\tPlayer1[X] \n\tPlayer2[O]\n\n";
-
-    std::cout << "\t\t      |      |     \n";
-    std::cout << "\t\t  " << board[0][0] << "   |  " << board[0][1] << "   |  " << board[0][2] << "  \n";
-    std::cout << "\t\t______|______|______\n";
-    std::cout << "\t\t      |      |     \n";
-    std::cout << "\t\t  " << board[1][0] << "   |  " << board[1][1] << "   |  " << board[1][2] << "  \n";
-    std::cout << "\t\t______|______|______\n";
-    std::cout << "\t\t      |      |     \n";
-    std::cout << "\t\t  " << board[2][0] << "   |  " << board[2][1] << "   |  " << board[2][2] << "  \n";
-    std::cout << "\t\t      |      |      \n";
+    return side == 'X' ? 'O' : 'X';
 }
 
-bool isValidMove(int choice, int &row, int &col)
+// Monte Carlo Tree Search (UCT) with random bitboard playouts. Nodes live in a
+// fixed-size pool and refer to each other by index; the children of a node are
+// stored next to each other. The subtree under the position we end up in is
+// kept between moves, and the pool is compacted down to it once it is half full.
+class MctsEngine : public AiEngine
 {
-    if (choice < 1 || choice > 9)
-        return false;
-    row = (choice - 1) / 3;
-    col = (choice - 1) % 3;
+public:
+    explicit MctsEngine(int iterations = 20000, size_t capacity = 1 << 18, uint32_t seed = 2463534242u)
+        : iterations(iterations), capacity(capacity), rng(seed ? seed : 1)
+    {
+        pool.reserve(capacity);
+    }
 
-    return board[row][col] != 'X' && board[row][col] != 'O';
-}
+    const char *name() const override { return "MCTS"; }
 
-void player_turn()
-{
-    int choice;
+    int chooseMove(char b[3][3], char side) override
+    {
+        uint16_t x = 0, o = 0;
+        for (int i = 0; i < 9; i++)
+        {
+            if (b[i / 3][i % 3] == 'X')
+                x |= 1 << i;
+            else if (b[i / 3][i % 3] == 'O')
+                o |= 1 << i;
+        }
+        if ((x | o) == FULL_BOARD)
+            return -1;
+
+        setRoot(x, o, side);
+        nodes = 0;
+
+        std::vector<int> path;
+        for (int it = 0; it < iterations; it++)
+        {
+            path.clear();
+            int n = root;
+            path.push_back(n);
+            while (pool[n].childCount > 0)
+            {
+                n = selectChild(n);
+                path.push_back(n);
+            }
+
+            char result = terminalResult(pool[n]);
+            if (!result)
+            {
+                if (expand(n))
+                {
+                    n = pool[n].firstChild;
+                    path.push_back(n);
+                    result = terminalResult(pool[n]);
+                }
+                if (!result)
+                    result = rollout(pool[n]);
+            }
+
+            nodes += (long long)path.size();
+            for (int k : path)
+            {
+                pool[k].visits++;
+                if (result == pool[k].mover)
+                    pool[k].score += 1.0f;
+                else if (result == 'D')
+                    pool[k].score += 0.5f;
+            }
+        }
+
+        // Most visited child; ties go to the lower cell.
+        int best = -1, bestVisits = -1;
+        for (int c = 0; c < pool[root].childCount; c++)
+        {
+            const Node &child = pool[pool[root].firstChild + c];
+            if (child.visits > bestVisits)
+            {
+                bestVisits = child.visits;
+                best = child.move;
+            }
+        }
+        if (best < 0)
+        {
+            for (int i = 0; i < 9; i++)
+                if (!(((x | o) >> i) & 1))
+                    return i;
+        }
+        return best;
+    }
+
+private:
+    struct Node
+    {
+        uint16_t x, o;      // stones after this node's move
+        int8_t move;        // cell played to get here, -1 at a fresh root
+        char mover;         // side that played it
+        uint8_t childCount; // 0 until expanded
+        int firstChild;
+        int visits;
+        float score; // playout results from the mover's point of view
+    };
 
-    if (turn == 'X')
+    int iterations;
+    size_t capacity;
+    uint32_t rng;
+    std::vector<Node> pool;
+    int root = -1;
+
+    int newNode(uint16_t x, uint16_t o, int move, char mover)
     {
-        std::cout << "\n\t Player1 [X] turn: ";
-        std::cin >> choice;
+        pool.push_back({x, o, (int8_t)move, mover, 0, -1, 0, 0.0f});
+        return (int)pool.size() - 1;
+    }
 
-        int row = (choice - 1) / 3;
-        int col = (choice - 1) % 3;
+    bool matches(int n, uint16_t x, uint16_t o, char side) const
+    {
+        return pool[n].x == x && pool[n].o == o && pool[n].mover != side;
+    }
 
-        if (choice < 1 || choice > 9 || board[row][col] == 'X' || board[row][col] == 'O')
+    // Reuse the old tree if the position is the root or one or two plies below
+    // it (our last move and the reply), otherwise start over.
+    void setRoot(uint16_t x, uint16_t o, char side)
+    {
+        int found = -1;
+        if (root >= 0)
         {
-            std::cout << "Invalid move. Try again.\n";
-            player_turn();
+            if (matches(root, x, o, side))
+                found = root;
+            for (int c = 0; found < 0 && c < pool[root].childCount; c++)
+            {
+                int child = pool[root].firstChild + c;
+                if (matches(child, x, o, side))
+                    found = child;
+                for (int g = 0; found < 0 && g < pool[child].childCount; g++)
+                    if (matches(pool[child].firstChild + g, x, o, side))
+                        found = pool[child].firstChild + g;
+            }
         }
-        else
+
+        if (found < 0)
         {
-            board[row][col] = 'X';
-            turn = 'O';
+            pool.clear();
+            root = newNode(x, o, -1, otherSide(side));
+            return;
         }
+
+        root = found;
+        if (pool.size() > capacity / 2)
+            compact();
     }
-    else
+
+    // Copy the subtree under root to the front of a fresh pool, breadth first so
+    // sibling blocks stay contiguous.
+    void compact()
     {
-        if (vsAi)
+        std::vector<Node> fresh;
+        fresh.reserve(capacity);
+        fresh.push_back(pool[root]);
+        for (size_t i = 0; i < fresh.size(); i++)
         {
-            bestMove();
+            if (fresh[i].childCount == 0)
+                continue;
+            int oldFirst = fresh[i].firstChild;
+            fresh[i].firstChild = (int)fresh.size();
+            for (int c = 0; c < fresh[i].childCount; c++)
+                fresh.push_back(pool[oldFirst + c]);
         }
-        else
+        pool.swap(fresh);
+        root = 0;
+    }
+
+    // Winner of a node's position, 'D' for a full board, 0 if still open.
+    char terminalResult(const Node &n) const
+    {
+        if (hasLine(n.mover == 'X' ? n.x : n.o))
+            return n.mover;
+        if ((n.x | n.o) == FULL_BOARD)
+            return 'D';
+        return 0;
+    }
+
+    bool expand(int n)
+    {
+        if (pool.size() + 9 > capacity)
+            return false;
+        uint16_t x = pool[n].x, o = pool[n].o;
+        char side = otherSide(pool[n].mover);
+        int first = (int)pool.size();
+        int count = 0;
+        for (int i = 0; i < 9; i++)
+        {
+            uint16_t bit = 1 << i;
+            if ((x | o) & bit)
+                continue;
+            if (side == 'X')
+                newNode(x | bit, o, i, side);
+            else
+                newNode(x, o | bit, i, side);
+            count++;
+        }
+        pool[n].firstChild = first;
+        pool[n].childCount = (uint8_t)count;
+        return count > 0;
+    }
+
+    int selectChild(int n)
+    {
+        const double C = 1.41;
+        double logVisits = std::log((double)pool[n].visits);
+        int best = -1;
+        double bestValue = -1.0;
+        for (int c = 0; c < pool[n].childCount; c++)
+        {
+            int child = pool[n].firstChild + c;
+            if (pool[child].visits == 0)
+                return child;
+            double value = pool[child].score / pool[child].visits + C * std::sqrt(logVisits / pool[child].visits);
+            if (value > bestValue)
+            {
+                bestValue = value;
+                best = child;
+            }
+        }
+        return best;
+    }
+
+    // Plays random moves from n until the game ends and returns the winner or 'D'.
+    char rollout(const Node &n)
+    {
+        uint16_t x = n.x, o = n.o;
+        char side = otherSide(n.mover);
+        while (true)
         {
-            std::cout << "\n\t Player2 [O] turn: ";
-            std::cin >> choice;
+            uint16_t empty = ~(x | o) & FULL_BOARD;
+            if (!empty)
+                return 'D';
 
-            int row = (choice - 1) / 3;
-            int col = (choice - 1) % 3;
+            int cells[9], count = 0;
+            for (int i = 0; i < 9; i++)
+                if ((empty >> i) & 1)
+                    cells[count++] = i;
+            uint16_t bit = 1 << cells[nextRandom(rng) % count];
+            nodes++;
 
-            if (choice < 1 || choice > 9 || board[row][col] == 'X' || board[row][col] == 'O')
+            if (side == 'X')
             {
-                std::cout << "Invalid move. Try again.\n";
-                player_turn();
+                x |= bit;
+                if (hasLine(x))
+                    return 'X';
             }
             else
             {
-                board[row][col] = 'O';
-                turn = 'X';
+                o |= bit;
+                if (hasLine(o))
+                    return 'O';
             }
+            side = otherSide(side);
+        }
+    }
+};
+
+AiEngine *aiEngine = nullptr;
+
+// ==========================
+// Game state and rules
+// ==========================
+
+// Game state shared by the interactive game and the self-play runner.
+struct Game
+{
+    char board[3][3];
+    char turn;
+};
+
+void resetGame(Game &g)
+{
+    for (int i = 0; i < 9; i++)
+        g.board[i / 3][i % 3] = '1' + i;
+    g.turn = 'X';
+}
+
+// 'X' or 'O' for a winner, 'D' for a draw, 0 while the game is still on.
+char gameResult(Game &g)
+{
+    int score = evaluate(g.board);
+    if (score == 10)
+        return 'O';
+    if (score == -10)
+        return 'X';
+    return isMovesLeft(g.board) ? 0 : 'D';
+}
+
+// Plays cell (0-8) for the side to move. Returns false if the move is illegal.
+bool applyMove(Game &g, int cell)
+{
+    if (cell < 0 || cell > 8 || gameResult(g) != 0)
+        return false;
+    char &c = g.board[cell / 3][cell % 3];
+    if (c == 'X' || c == 'O')
+        return false;
+    c = g.turn;
+    g.turn = otherSide(g.turn);
+    return true;
+}
+
+// display_board() clears the screen with ANSI codes. The Windows console only
+// interprets them once virtual-terminal processing is switched on.
+void enableAnsiConsole()
+{
+#ifdef _WIN32
+    HANDLE out = GetStdHandle(STD_OUTPUT_HANDLE);
+    DWORD consoleMode = 0;
+    if (out != INVALID_HANDLE_VALUE && GetConsoleMode(out, &consoleMode))
+        SetConsoleMode(out, consoleMode | ENABLE_VIRTUAL_TERMINAL_PROCESSING);
+#endif
+}
+
+void display_board(const Game &g)
+{
+    std::cout << "\033[2J\033[H"; // ANSI clear screen + cursor home
+    std::cout << "\n     T i c k   C r o s s   G a m e" << std::endl;
+    std::cout << "\tPlayer1[X] \n\tPlayer2[O]\n\n";
+
+    std::cout << "\t\t      |      |     \n";
+    std::cout << "\t\t  " << g.board[0][0] << "   |  " << g.board[0][1] << "   |  " << g.board[0][2] << "  \n";
+    std::cout << "\t\t______|______|______\n";
+    std::cout << "\t\t      |      |     \n";
+    std::cout << "\t\t  " << g.board[1][0] << "   |  " << g.board[1][1] << "   |  " << g.board[1][2] << "  \n";
+    std::cout << "\t\t______|______|______\n";
+    std::cout << "\t\t      |      |     \n";
+    std::cout << "\t\t  " << g.board[2][0] << "   |  " << g.board[2][1] << "   |  " << g.board[2][2] << "  \n";
+    std::cout << "\t\t      |      |      \n";
+}
+
+// Prompts until the player enters a free cell 1-9 and plays it.
+void readMove(Game &g, const char *prompt)
+{
+    int choice;
+    while (true)
+    {
+        std::cout << prompt;
+        if (std::cin >> choice)
+        {
+            if (applyMove(g, choice - 1))
+                return;
         }
+        else
+        {
+            if (std::cin.eof())
+                std::exit(0);
+            std::cin.clear();
+            std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+        }
+        std::cout << "Invalid move. Try again.\n";
+    }
+}
+
+void player_turn(Game &g)
+{
+    if (g.turn == 'O' && vsAi)
+    {
+        applyMove(g, aiEngine->chooseMove(g.board, 'O'));
+        return;
     }
+
+    readMove(g, g.turn == 'X' ? "\n\t Player1 [X] turn: " : "\n\t Player2 [O] turn: ");
 }
 
-bool isMovesLeft()
+bool isMovesLeft(char b[3][3])
 {
     for (int i = 0; i < 3; i++)
         for (int j = 0; j < 3; j++)
-            if (board[i][j] != 'X' && board[i][j] != 'O')
+            if (b[i][j] != 'X' && b[i][j] != 'O')
                 return true;
     return false;
 }
 
-int minimax(int depth, bool isMax) //for ai not , for player 1 --> ai moves to a position and after that predicts user moves and with lowest user move value / highest ai move value it chooses the original move  
+int minimax(char b[3][3], int depth, bool isMax) //for ai not , for player 1 --> ai moves to a position and after that predicts user moves and with lowest user move value / highest ai move value it chooses the original move  
 { // false
-    int score = evaluate();
+    nodeCount++;
+    int score = evaluate(b);
     if (score == 10 || score == -10)
         return score;
-    if (!isMovesLeft())
+    if (!isMovesLeft(b))
         return 0;
 
+    int key = 0;
+    if (useTT)
+    {
+        key = positionKey(b, isMax);
+        signed char cached = transposition[key].load(std::memory_order_relaxed);
+        if (cached != 0)
+            return cached - TT_BIAS;
+    }
+
     if (isMax)
     {
         int best = -1000;
@@ -190,15 +703,17 @@ int minimax(int depth, bool isMax) //for ai not , for player 1 --> ai moves to a
         {
             for (int j = 0; j < 3; j++)
             {
-                if (board[i][j] != 'X' && board[i][j] != 'O')
+                if (b[i][j] != 'X' && b[i][j] != 'O')
                 {
-                    char temp = board[i][j];
-                    board[i][j] = 'O';
-                    best = std::max(best, minimax(depth + 1, !isMax));
-                    board[i][j] = temp;
+                    char temp = b[i][j];
+                    b[i][j] = 'O';
+                    best = std::max(best, minimax(b, depth + 1, !isMax));
+                    b[i][j] = temp;
                 }
             }
         }
+        if (useTT)
+            transposition[key].store(best + TT_BIAS, std::memory_order_relaxed);
         return best;
     }
     else
@@ -208,43 +723,253 @@ int minimax(int depth, bool isMax) //for ai not , for player 1 --> ai moves to a
         {
             for (int j = 0; j < 3; j++)
             {
-                if (board[i][j] != 'X' && board[i][j] != 'O')
+                if (b[i][j] != 'X' && b[i][j] != 'O')
                 {
-                    char temp = board[i][j];
-                    board[i][j] = 'X';
-                    best = std::min(best, minimax(depth + 1, !isMax));
-                    board[i][j] = temp;
+                    char temp = b[i][j];
+                    b[i][j] = 'X';
+                    best = std::min(best, minimax(b, depth + 1, !isMax));
+                    b[i][j] = temp;
                 }
             }
         }
+        if (useTT)
+            transposition[key].store(best + TT_BIAS, std::memory_order_relaxed);
         return best;
     }
 }
 
-int main()
+const char *ENGINE_NAMES[] = {"minimax", "mcts", "random"};
+
+bool isEngineName(const std::string &name)
+{
+    for (const char *known : ENGINE_NAMES)
+        if (name == known)
+            return true;
+    return false;
+}
+
+std::unique_ptr<AiEngine> makeEngine(const std::string &name, uint32_t seed)
+{
+    if (name == "minimax")
+        return std::unique_ptr<AiEngine>(new MinimaxEngine(1));
+    if (name == "mcts")
+        return std::unique_ptr<AiEngine>(new MctsEngine(20000, 1 << 18, seed));
+    if (name == "random")
+        return std::unique_ptr<AiEngine>(new RandomEngine(seed));
+    return nullptr;
+}
+
+struct SelfPlayStats
+{
+    long long xWins = 0, oWins = 0, draws = 0, moves = 0;
+    long long nodes[2] = {0, 0};
+    LatencyHistogram latency[2]; // [0] = X engine, [1] = O engine
+    std::string error;           // set if an engine played an illegal move
+};
+
+// Plays `games` engine-vs-engine games split over `threads` threads, each with
+// its own engine instances, and prints throughput, results and move latency.
+// Stops and returns false if an engine plays an illegal move.
+bool selfPlay(long long games, int threads, const std::string &xName, const std::string &oName)
+{
+    if (!isEngineName(xName) || !isEngineName(oName))
+    {
+        std::cout << "Unknown engine. Use minimax, mcts or random.\n";
+        return false;
+    }
+    threads = std::max(1, threads);
+    std::vector<SelfPlayStats> stats(threads);
+    std::atomic<bool> failed(false);
+
+    auto worker = [&](int t)
+    {
+        std::unique_ptr<AiEngine> engines[2] = {makeEngine(xName, 2 * t + 1), makeEngine(oName, 2 * t + 2)};
+        SelfPlayStats &st = stats[t];
+        Game g;
+        for (long long n = games * t / threads; n < games * (t + 1) / threads && !failed; n++)
+        {
+            resetGame(g);
+            char result = 0;
+            while (result == 0)
+            {
+                int side = (g.turn == 'X') ? 0 : 1;
+                auto start = std::chrono::steady_clock::now();
+                int cell = engines[side]->chooseMove(g.board, g.turn);
+                auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+                st.latency[side].add(ns);
+                st.nodes[side] += engines[side]->lastNodes();
+                st.moves++;
+                if (!applyMove(g, cell))
+                {
+                    st.error = std::string(engines[side]->name()) + " (" + g.turn + ") played illegal cell " +
+                               std::to_string(cell) + " in game " + std::to_string(n);
+                    failed = true;
+                    return;
+                }
+                result = gameResult(g);
+            }
+            if (result == 'X')
+                st.xWins++;
+            else if (result == 'O')
+                st.oWins++;
+            else
+                st.draws++;
+        }
+    };
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> pool;
+    for (int t = 1; t < threads; t++)
+        pool.emplace_back(worker, t);
+    worker(0);
+    for (auto &th : pool)
+        th.join();
+    double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    for (const SelfPlayStats &st : stats)
+    {
+        if (!st.error.empty())
+        {
+            std::cout << "Aborted: " << st.error << "\n";
+            return false;
+        }
+    }
+
+    SelfPlayStats total;
+    for (const SelfPlayStats &st : stats)
+    {
+        total.xWins += st.xWins;
+        total.oWins += st.oWins;
+        total.draws += st.draws;
+        total.moves += st.moves;
+        for (int side = 0; side < 2; side++)
+        {
+            total.nodes[side] += st.nodes[side];
+            total.latency[side].merge(st.latency[side]);
+        }
+    }
+
+    auto pct = [&](long long n)
+    { return games > 0 ? 100.0 * n / games : 0.0; };
+
+    std::cout << std::fixed << std::setprecision(2)
+              << "games: " << games << "  threads: " << threads
+              << "  X: " << xName << "  O: " << oName << "\n"
+              << "time: " << secs << " s  games/sec: " << games / secs
+              << "  moves/sec: " << total.moves / secs << "\n"
+              << "X wins: " << total.xWins << " (" << pct(total.xWins) << "%)"
+              << "  O wins: " << total.oWins << " (" << pct(total.oWins) << "%)"
+              << "  draws: " << total.draws << " (" << pct(total.draws) << "%)\n\n"
+              << "side      moves        nodes     nodes/sec   p50 us   p90 us   p99 us   max us\n";
+    for (int side = 0; side < 2; side++)
+    {
+        const LatencyHistogram &h = total.latency[side];
+        double engineSecs = h.sumNs / 1e9;
+        std::cout << std::setw(4) << (side == 0 ? 'X' : 'O')
+                  << std::setw(11) << h.total
+                  << std::setw(13) << total.nodes[side]
+                  << std::setw(14) << std::setprecision(0) << (engineSecs > 0 ? total.nodes[side] / engineSecs : 0.0)
+                  << std::setprecision(2)
+                  << std::setw(9) << h.percentile(0.50) / 1000.0
+                  << std::setw(9) << h.percentile(0.90) / 1000.0
+                  << std::setw(9) << h.percentile(0.99) / 1000.0
+                  << std::setw(9) << h.maxNs / 1000.0 << "\n";
+    }
+    return true;
+}
+
+// Solves the empty board from 1 to maxThreads threads, with and without the
+// transposition table, and prints time-to-solve and nodes/sec for each run.
+void benchmark(int maxThreads)
+{
+    const int reps = 20;
+    bool savedTT = useTT;
+
+    char b[3][3];
+    std::cout << "hardware threads: " << hardwareThreads << "\n"
+              << "threads   tt   ms/solve        nodes   Mnodes/s  speedup\n";
+    for (int tt = 0; tt < 2; tt++)
+    {
+        useTT = (tt == 1);
+        double baseMs = 0;
+        for (int t = 1; t <= maxThreads; t++)
+        {
+            long long totalNodes = 0;
+            // Warm-up solve so pool threads are already started when timing begins.
+            for (int i = 0; i < 9; i++)
+                b[i / 3][i % 3] = '1' + i;
+            searchRoot(b, 'O', t);
+
+            auto start = std::chrono::steady_clock::now();
+            for (int r = 0; r < reps; r++)
+            {
+                long long nodes = 0;
+                clearTT();
+                searchRoot(b, 'O', t, &nodes);
+                totalNodes += nodes;
+            }
+            double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / reps;
+            long long nodes = totalNodes / reps;
+            if (t == 1)
+                baseMs = ms;
+
+            std::cout << std::setw(7) << t
+                      << std::setw(5) << (useTT ? "on" : "off")
+                      << std::setw(11) << std::fixed << std::setprecision(3) << ms
+                      << std::setw(13) << nodes
+                      << std::setw(11) << std::setprecision(2) << (ms > 0 ? nodes / ms / 1000.0 : 0.0)
+                      << std::setw(9) << (ms > 0 ? baseMs / ms : 0.0) << "x\n";
+        }
+    }
+
+    clearTT();
+    useTT = savedTT;
+}
+
+int main(int argc, char *argv[])
 {
+    if (argc > 1 && std::string(argv[1]) == "--bench")
+    {
+        benchmark(argc > 2 ? std::max(1, std::atoi(argv[2])) : hardwareThreads);
+        return 0;
+    }
+    if (argc > 1 && std::string(argv[1]) == "--selfplay")
+    {
+        long long games = argc > 2 ? std::atoll(argv[2]) : 100000;
+        int threads = argc > 3 ? std::atoi(argv[3]) : hardwareThreads;
+        bool ok = selfPlay(std::max(0LL, games), threads,
+                           argc > 4 ? argv[4] : "minimax",
+                           argc > 5 ? argv[5] : "random");
+        return ok ? 0 : 1;
+    }
+
+    enableAnsiConsole();
+
     int mode;
-    std::cout << "\nSelect Mode: \n1. Player vs Player\n2. Player vs AI\nChoice: ";
+    std::cout << "\nSelect Mode: \n1. Player vs Player\n2. Player vs AI (Minimax)\n3. Player vs AI (MCTS)\nChoice: ";
     std::cin >> mode;
 
-    vsAi = (mode == 2);
+    MinimaxEngine minimaxAi;
+    MctsEngine mctsAi;
+    vsAi = (mode == 2 || mode == 3);
+    aiEngine = (mode == 3) ? (AiEngine *)&mctsAi : (AiEngine *)&minimaxAi;
 
-    while (gameOver())
+    Game game;
+    resetGame(game);
+    char result;
+    while ((result = gameResult(game)) == 0)
     {
-        display_board();
-        player_turn();
+        display_board(game);
+        player_turn(game);
     }
 
-    display_board();
-    if (draw)
+    display_board(game);
+    if (result == 'D')
         std::cout << "\nIt's a a draw" << std::endl;
+    else if (result == 'O')
+        std::cout << "\nPlayer2 [O] Wins! Congratulations!" << std::endl;
     else
-    {
-        if (turn == 'X')
-            std::cout << "\nPlayer2 [O] Wins! Congratulations!" << std::endl;
-        else
-            std::cout << "\nPlayer1 [X] Wins! Congratulations!" << std::endl;
-    }
+        std::cout << "\nPlayer1 [X] Wins! Congratulations!" << std::endl;
 
     return 0;
 }